@@ -41,7 +41,7 @@ build_jni() {
     -I"$JAVA_HOME/include" \
     -I"$JAVA_HOME/include/$JNI_MD_DIR" \
     -I"$ROOT_DIR/deps/bc-ur/src" \
-    -fexceptions -frtti -std=c++17 -stdlib=libc++ -shared -fPIC \
+    -fexceptions -frtti -std=c++17 -stdlib=libc++ -shared -fPIC -pthread \
     src/main/jniLibs/bc-ur.cpp \
     "$ROOT_DIR"/deps/bc-ur/src/libbc-ur.a \
     -o \
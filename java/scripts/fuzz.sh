@@ -0,0 +1,69 @@
+#!/bin/bash
+
+# Builds the libFuzzer targets and the worst-case receive part benchmark for the native
+# decode path. Fuzzers need clang with libFuzzer support.
+#
+# Usage: CC="clang-10" CXX="clang++-10" ./scripts/fuzz.sh [decode|receive-part|bench] [libFuzzer args...]
+#
+# bc-ur is rebuilt for the selected target, run ./scripts/build.sh again before building the
+# JNI library.
+
+set -e
+
+echo "${CC:?}"
+echo "${CXX:?}"
+
+ROOT_DIR=$(
+  cd ..
+  pwd
+)
+
+OUT_DIR=build/fuzz
+BC_UR_DIR="$ROOT_DIR/deps/bc-ur/src"
+CXXFLAGS=(-I"$BC_UR_DIR" -Isrc/main/jniLibs -fexceptions -frtti -std=c++17 -g)
+
+build_bc_ur() {
+  pushd "$ROOT_DIR"/deps/bc-ur
+  ./configure
+  make clean
+  make CPPFLAGS="-fPIC $1"
+  popd
+}
+
+build_fuzzer() {
+  NAME=$1
+  $CXX "${CXXFLAGS[@]}" -O1 -fsanitize=fuzzer,address,undefined \
+    src/fuzz/"$NAME"-fuzzer.cpp \
+    "$BC_UR_DIR"/libbc-ur.a \
+    -o "$OUT_DIR/$NAME-fuzzer"
+}
+
+build_bench() {
+  $CXX "${CXXFLAGS[@]}" -O2 \
+    src/fuzz/receive-part-bench.cpp \
+    "$BC_UR_DIR"/libbc-ur.a \
+    -o "$OUT_DIR/receive-part-bench"
+}
+
+TARGET=${1:-receive-part}
+shift || true
+
+mkdir -p "$OUT_DIR"
+
+case "$TARGET" in
+decode | receive-part)
+  build_bc_ur "-fsanitize=fuzzer-no-link,address,undefined"
+  build_fuzzer "$TARGET"
+  mkdir -p "$OUT_DIR/corpus/$TARGET"
+  "$OUT_DIR/$TARGET-fuzzer" -max_len=4096 -timeout=5 -rss_limit_mb=512 "$@" "$OUT_DIR/corpus/$TARGET"
+  ;;
+bench)
+  build_bc_ur "-O2"
+  build_bench
+  "$OUT_DIR/receive-part-bench"
+  ;;
+*)
+  echo "Unknown target '$TARGET'"
+  exit 1
+  ;;
+esac
@@ -0,0 +1,15 @@
+// libFuzzer target for the single-part decode path behind URDecoder_decode.
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "decoder-limits.hpp"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    std::string encoded(reinterpret_cast<const char *>(data), size);
+    try {
+        LimitedURDecoder::decode(encoded, 64 * 1024);
+    } catch (const std::exception &) {
+        // surfaced to Java as URException
+    }
+    return 0;
+}
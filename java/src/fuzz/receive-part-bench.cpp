@@ -0,0 +1,146 @@
+// Measures the worst-case cost of a single received part, with and without DecoderLimits.
+//
+// A valid stream of fountain parts only is replayed to report the overhead of the limit checks
+// against the unlimited ur::URDecoder baseline, then two adversarial streams:
+//   mixed-only  a real multi-part UR with every simple part dropped, so no mixed part is ever
+//               reduced and each new part is checked against the whole pending queue
+//   huge-seq    forged parts announcing a huge `seq-len`, which makes fragment selection
+//               build a degree distribution proportional to it
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "decoder-limits.hpp"
+
+using namespace ur;
+
+struct Stats {
+    size_t parts = 0;
+    size_t rejected = 0;
+    double total_us = 0;
+    double max_us = 0;
+};
+
+static Stats replay(const std::vector<std::string> &parts, const DecoderLimits &limits) {
+    LimitedURDecoder decoder(limits);
+    Stats stats;
+    for (const auto &part: parts) {
+        auto start = std::chrono::steady_clock::now();
+        try {
+            decoder.receive_part(part);
+        } catch (const DecoderLimitExceeded &) {
+            stats.rejected++;
+        } catch (const std::exception &) {
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        auto us = std::chrono::duration<double, std::micro>(end - start).count();
+        stats.parts++;
+        stats.total_us += us;
+        stats.max_us = std::max(stats.max_us, us);
+    }
+    return stats;
+}
+
+static void add(Stats &total, const Stats &stats) {
+    total.parts += stats.parts;
+    total.rejected += stats.rejected;
+    total.total_us += stats.total_us;
+    total.max_us = std::max(total.max_us, stats.max_us);
+}
+
+static void print(const char *name, const char *limits, const Stats &stats) {
+    printf("%-12s %-10s parts=%-6zu rejected=%-6zu avg=%10.1fus max=%10.1fus\n",
+           name,
+           limits,
+           stats.parts,
+           stats.rejected,
+           stats.parts == 0 ? 0 : stats.total_us / stats.parts,
+           stats.max_us);
+}
+
+static void print_overhead(const char *name, const Stats &baseline, const Stats &limited) {
+    printf("%-12s overhead=%+.1f%%\n",
+           name,
+           baseline.total_us == 0 ? 0 : (limited.total_us / baseline.total_us - 1) * 100);
+}
+
+static std::vector<std::string> valid_parts(size_t message_len, size_t fragment_len) {
+    Xoshiro256 rng("Wolf");
+    ByteVector cbor;
+    CborLite::encodeBytes(cbor, rng.next_data(message_len));
+    UR ur("bytes", cbor);
+
+    // start past the simple parts so that every part goes through fragment selection
+    auto seq_len = UREncoder(ur, fragment_len).seq_len();
+    UREncoder encoder(ur, fragment_len, (uint32_t) seq_len);
+
+    LimitedURDecoder decoder((DecoderLimits()));
+    std::vector<std::string> parts;
+    while (!decoder.is_complete()) {
+        parts.push_back(encoder.next_part());
+        decoder.receive_part(parts.back());
+    }
+    return parts;
+}
+
+static std::vector<std::string> mixed_only_parts(size_t message_len, size_t fragment_len,
+                                                 size_t count) {
+    Xoshiro256 rng("Wolf");
+    ByteVector cbor;
+    CborLite::encodeBytes(cbor, rng.next_data(message_len));
+    UREncoder encoder(UR("bytes", cbor), fragment_len);
+
+    std::vector<std::string> parts;
+    while (parts.size() < count) {
+        auto part = encoder.next_part();
+        if (encoder.last_part_indexes().size() > 1)
+            parts.push_back(part);
+    }
+    return parts;
+}
+
+static std::vector<std::string> huge_seq_parts(size_t seq_len, size_t count) {
+    std::vector<std::string> parts;
+    ByteVector data(10, 0);
+    for (size_t i = 0; i < count; i++) {
+        auto seq_num = (uint32_t) (seq_len + i + 1);
+        FountainEncoder::Part part(seq_num, seq_len, seq_len * data.size(), 0, data);
+        auto body = Bytewords::encode(Bytewords::style::minimal, part.cbor());
+        parts.push_back("ur:bytes/" + std::to_string(seq_num) + "-" + std::to_string(seq_len) +
+                        "/" + body);
+    }
+    return parts;
+}
+
+int main() {
+    DecoderLimits unlimited;
+    DecoderLimits limited;
+    limited.max_expected_parts = 1024;
+    limited.max_pending_mixed_parts = 256;
+    limited.max_retained_bytes = 1024 * 1024;
+    limited.max_reduction_work = 4 * 1024 * 1024;
+
+    // 656 fragments, within max_expected_parts; repeated so timer resolution does not dominate
+    auto valid = valid_parts(128 * 1024, 200);
+    Stats valid_unlimited, valid_limited;
+    for (int i = 0; i < 20; i++) {
+        add(valid_unlimited, replay(valid, unlimited));
+        add(valid_limited, replay(valid, limited));
+    }
+    print("valid", "unlimited", valid_unlimited);
+    print("valid", "limited", valid_limited);
+    print_overhead("valid", valid_unlimited, valid_limited);
+
+    auto mixed = mixed_only_parts(128 * 1024, 200, 2000);
+    auto mixed_unlimited = replay(mixed, unlimited);
+    auto mixed_limited = replay(mixed, limited);
+    print("mixed-only", "unlimited", mixed_unlimited);
+    print("mixed-only", "limited", mixed_limited);
+
+    auto huge = huge_seq_parts(10 * 1000 * 1000, 20);
+    print("huge-seq", "unlimited", replay(huge, unlimited));
+    print("huge-seq", "limited", replay(huge, limited));
+    return 0;
+}
@@ -0,0 +1,33 @@
+// libFuzzer target for the multi-part decode path behind URDecoder_receive_part.
+// Every line of the input is received as one part by the same decoder.
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "decoder-limits.hpp"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    DecoderLimits limits;
+    limits.max_expected_parts = 1024;
+    limits.max_pending_mixed_parts = 256;
+    limits.max_retained_bytes = 1024 * 1024;
+    limits.max_reduction_work = 4 * 1024 * 1024;
+    LimitedURDecoder decoder(limits);
+
+    std::string input(reinterpret_cast<const char *>(data), size);
+    size_t begin = 0;
+    while (begin <= input.size()) {
+        auto end = input.find('\n', begin);
+        if (end == std::string::npos)
+            end = input.size();
+
+        try {
+            decoder.receive_part(input.substr(begin, end - begin));
+        } catch (const std::exception &) {
+            // surfaced to Java as URException, the decoder stays usable
+        }
+        if (decoder.is_complete())
+            break;
+        begin = end + 1;
+    }
+    return 0;
+}
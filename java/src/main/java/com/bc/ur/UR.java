@@ -1,13 +1,20 @@
 package com.bc.ur;
 
+import java.nio.ByteBuffer;
 import java.util.regex.Pattern;
 
-import static com.bc.ur.URJni.UR_get_message;
 import static com.bc.ur.URJni.UR_new_from_message;
 
 public class UR {
 
-    private static final String UR_TYPE_PATTERN = "^[a-z0-9-]+$";
+    private static final Pattern UR_TYPE_PATTERN = Pattern.compile("^[a-z0-9-]+$");
+
+    // CBOR major type 2 (byte string)
+    private static final int CBOR_MAJOR_TYPE_BYTES = 0x40;
+
+    private static final int CBOR_MAJOR_TYPE_MASK = 0xe0;
+
+    private static final int CBOR_ADDITIONAL_INFO_MASK = 0x1f;
 
     public static UR create(String type, byte[] message) {
         return UR_new_from_message(type, message);
@@ -21,6 +28,9 @@ public class UR {
 
     private final byte[] cbor;
 
+    // read-only view of the message inside cbor, parsed on first access
+    private volatile ByteBuffer message;
+
     private UR(String type, byte[] cbor) {
         validateType(type);
         this.type = type;
@@ -28,9 +38,9 @@ public class UR {
     }
 
     private void validateType(String type) {
-        if (Pattern.compile(UR_TYPE_PATTERN).matcher(type).matches())
+        if (UR_TYPE_PATTERN.matcher(type).matches())
             return;
-        throw new URException("Invalid UR type. Valid pattern is " + UR_TYPE_PATTERN);
+        throw new URException("Invalid UR type. Valid pattern is " + UR_TYPE_PATTERN.pattern());
     }
 
     public byte[] getCbor() {
@@ -42,6 +52,55 @@ public class UR {
     }
 
     public byte[] getMessage() {
-        return UR_get_message(this);
+        ByteBuffer buffer = getMessageBuffer();
+        byte[] message = new byte[buffer.remaining()];
+        buffer.get(message);
+        return message;
+    }
+
+    /**
+     * Returns a read-only view of the message backed by the CBOR array, without copying it.
+     * Each call returns an independent buffer positioned at the start of the message.
+     */
+    public ByteBuffer getMessageBuffer() {
+        ByteBuffer message = this.message;
+        if (message == null) {
+            message = decodeMessage(cbor);
+            this.message = message;
+        }
+        return message.duplicate();
+    }
+
+    private static ByteBuffer decodeMessage(byte[] cbor) {
+        if (cbor == null || cbor.length == 0)
+            throw new URException("Invalid CBOR. Empty data");
+
+        int initialByte = cbor[0] & 0xff;
+        if ((initialByte & CBOR_MAJOR_TYPE_MASK) != CBOR_MAJOR_TYPE_BYTES)
+            throw new URException("Invalid CBOR. Expected a byte string");
+
+        int info = initialByte & CBOR_ADDITIONAL_INFO_MASK;
+        int headerLen;
+        long len;
+        if (info < 24) {
+            headerLen = 1;
+            len = info;
+        } else if (info <= 27) {
+            int lenBytes = 1 << (info - 24);
+            headerLen = 1 + lenBytes;
+            if (cbor.length < headerLen)
+                throw new URException("Invalid CBOR. Truncated byte string header");
+            len = 0;
+            for (int i = 1; i < headerLen; i++) {
+                len = (len << 8) | (cbor[i] & 0xff);
+            }
+        } else {
+            throw new URException("Invalid CBOR. Unsupported byte string length encoding");
+        }
+
+        if (len < 0 || len > cbor.length - headerLen)
+            throw new URException("Invalid CBOR. Byte string length exceeds data");
+
+        return ByteBuffer.wrap(cbor, headerLen, (int) len).slice().asReadOnlyBuffer();
     }
 }
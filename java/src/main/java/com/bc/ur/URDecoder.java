@@ -18,12 +18,29 @@ import static com.bc.ur.URJni.URDecoder_result_ur;
 
 public class URDecoder extends NativeWrapper {
 
+    public URDecoder(Limits limits) {
+        super(URDecoder_new(limits.maxExpectedParts,
+                            limits.maxPendingMixedParts,
+                            limits.maxRetainedBytes,
+                            limits.maxReductionWork));
+    }
+
     public URDecoder() {
-        super(URDecoder_new());
+        this(Limits.UNLIMITED);
+    }
+
+    /**
+     * Decodes a single-part UR, rejecting it with {@link URException} if its body would decode
+     * to more than {@code maxRetainedBytes}. A value of 0 disables the limit.
+     */
+    public static UR decode(String encoded, long maxRetainedBytes) {
+        if (maxRetainedBytes < 0)
+            throw new IllegalArgumentException("Limit must not be negative");
+        return URDecoder_decode(encoded, maxRetainedBytes);
     }
 
     public static UR decode(String encoded) {
-        return URDecoder_decode(encoded);
+        return decode(encoded, 0);
     }
 
     public String expectedType() {
@@ -80,4 +97,96 @@ public class URDecoder extends NativeWrapper {
             return;
         ptrObj = null;
     }
+
+    /**
+     * Resource limits checked by {@link #receivePart(String)} before a part reaches the native
+     * decoder. A part that would exceed a limit is rejected with {@link URException}. A value of
+     * 0 disables the corresponding limit. Costs that grow with the pending mixed parts are only
+     * charged to parts that would add to them, so parts that reduce the queue are always
+     * accepted.
+     */
+    public static final class Limits {
+
+        public static final Limits UNLIMITED = new Limits(0, 0, 0, 0);
+
+        private final long maxExpectedParts;
+
+        private final long maxPendingMixedParts;
+
+        private final long maxRetainedBytes;
+
+        private final long maxReductionWork;
+
+        private Limits(long maxExpectedParts,
+                       long maxPendingMixedParts,
+                       long maxRetainedBytes,
+                       long maxReductionWork) {
+            this.maxExpectedParts = requireNonNegative(maxExpectedParts);
+            this.maxPendingMixedParts = requireNonNegative(maxPendingMixedParts);
+            this.maxRetainedBytes = requireNonNegative(maxRetainedBytes);
+            this.maxReductionWork = requireNonNegative(maxReductionWork);
+        }
+
+        private static long requireNonNegative(long value) {
+            if (value < 0)
+                throw new IllegalArgumentException("Limit must not be negative");
+            return value;
+        }
+
+        /**
+         * Maximum `seq-len` a multi-part UR may announce.
+         */
+        public Limits withMaxExpectedParts(long maxExpectedParts) {
+            return new Limits(maxExpectedParts,
+                              maxPendingMixedParts,
+                              maxRetainedBytes,
+                              maxReductionWork);
+        }
+
+        /**
+         * Maximum number of mixed parts waiting to be reduced to simple parts.
+         */
+        public Limits withMaxPendingMixedParts(long maxPendingMixedParts) {
+            return new Limits(maxExpectedParts,
+                              maxPendingMixedParts,
+                              maxRetainedBytes,
+                              maxReductionWork);
+        }
+
+        /**
+         * Maximum number of bytes the decoder may hold for one message.
+         */
+        public Limits withMaxRetainedBytes(long maxRetainedBytes) {
+            return new Limits(maxExpectedParts,
+                              maxPendingMixedParts,
+                              maxRetainedBytes,
+                              maxReductionWork);
+        }
+
+        /**
+         * Maximum number of fragment bytes combined while reducing a single received part.
+         */
+        public Limits withMaxReductionWork(long maxReductionWork) {
+            return new Limits(maxExpectedParts,
+                              maxPendingMixedParts,
+                              maxRetainedBytes,
+                              maxReductionWork);
+        }
+
+        public long getMaxExpectedParts() {
+            return maxExpectedParts;
+        }
+
+        public long getMaxPendingMixedParts() {
+            return maxPendingMixedParts;
+        }
+
+        public long getMaxRetainedBytes() {
+            return maxRetainedBytes;
+        }
+
+        public long getMaxReductionWork() {
+            return maxReductionWork;
+        }
+    }
 }
@@ -0,0 +1,80 @@
+package com.bc.ur;
+
+import java.nio.Buffer;
+import java.nio.ByteBuffer;
+
+import static com.bc.ur.URJni.URFrameStream_dispose;
+import static com.bc.ur.URJni.URFrameStream_frame_capacity;
+import static com.bc.ur.URJni.URFrameStream_frame_count;
+import static com.bc.ur.URJni.URFrameStream_new;
+import static com.bc.ur.URJni.URFrameStream_next_frame;
+import static com.bc.ur.URJni.URFrameStream_seq_len;
+import static com.bc.ur.URJni.URFrameStream_start;
+
+/**
+ * Streams the parts of a {@link UREncoder} as uppercase bytes, ready for a QR alphanumeric mode
+ * encoder. A native producer thread runs up to {@code framesAhead} parts ahead of the consumer
+ * and writes them into a fixed ring of direct buffers, so {@link #nextFrame()} does not allocate.
+ * The buffers are allocated here and owned by the garbage collector.
+ */
+public class URFrameStream extends NativeWrapper {
+
+    private final ByteBuffer[] frames;
+
+    private long frameIndex;
+
+    public URFrameStream(UR ur,
+                         int maxFragmentLen,
+                         int firstSeqNum,
+                         int minFragmentLen,
+                         int framesAhead) {
+        super(URFrameStream_new(ur, maxFragmentLen, firstSeqNum, minFragmentLen, framesAhead));
+        try {
+            frames = startFrames(ptrObj);
+        } catch (Throwable e) {
+            URFrameStream_dispose(ptrObj);
+            ptrObj = null;
+            throw e;
+        }
+    }
+
+    public URFrameStream(UR ur, int maxFragmentLen, int framesAhead) {
+        this(ur, maxFragmentLen, 0, 10, framesAhead);
+    }
+
+    private static ByteBuffer[] startFrames(JniObject ptrObj) {
+        int capacity = URFrameStream_frame_capacity(ptrObj);
+        ByteBuffer[] buffers = new ByteBuffer[URFrameStream_frame_count(ptrObj)];
+        ByteBuffer[] frames = new ByteBuffer[buffers.length];
+        for (int i = 0; i < buffers.length; i++) {
+            buffers[i] = ByteBuffer.allocateDirect(capacity);
+            frames[i] = buffers[i].asReadOnlyBuffer();
+        }
+        URFrameStream_start(ptrObj, buffers);
+        return frames;
+    }
+
+    public long getSeqLen() {
+        return URFrameStream_seq_len(ptrObj);
+    }
+
+    /**
+     * Blocks until the next part is ready and returns it, positioned at the start of the part.
+     * The returned buffer is reused and its content is only stable until the next call.
+     */
+    public ByteBuffer nextFrame() {
+        int len = URFrameStream_next_frame(ptrObj);
+        ByteBuffer frame = frames[(int) (frameIndex++ % frames.length)];
+        // through Buffer, so the Java 8 signatures are linked when built on a newer JDK
+        ((Buffer) frame).clear();
+        ((Buffer) frame).limit(len);
+        return frame;
+    }
+
+    @Override
+    public void close() throws Exception {
+        if (isClosed() || !URFrameStream_dispose(ptrObj))
+            return;
+        ptrObj = null;
+    }
+}
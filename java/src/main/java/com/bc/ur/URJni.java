@@ -1,5 +1,7 @@
 package com.bc.ur;
 
+import java.nio.ByteBuffer;
+
 class URJni {
 
     static {
@@ -11,8 +13,6 @@ class URJni {
 
     static native UR UR_new_from_message(String type, byte[] message);
 
-    static native byte[] UR_get_message(UR ur);
-
     // UREncoder
     static native String UREncoder_encode(UR ur);
 
@@ -35,10 +35,32 @@ class URJni {
 
     static native boolean UREncoder_dispose(NativeWrapper.JniObject encoder);
 
+    // URFrameStream
+    static native NativeWrapper.JniObject URFrameStream_new(UR ur,
+                                                            int maxFragmentLen,
+                                                            int firstSeqNum,
+                                                            int minFragmentLen,
+                                                            int framesAhead);
+
+    static native int URFrameStream_frame_count(NativeWrapper.JniObject stream);
+
+    static native int URFrameStream_frame_capacity(NativeWrapper.JniObject stream);
+
+    static native boolean URFrameStream_start(NativeWrapper.JniObject stream, ByteBuffer[] frames);
+
+    static native long URFrameStream_seq_len(NativeWrapper.JniObject stream);
+
+    static native int URFrameStream_next_frame(NativeWrapper.JniObject stream);
+
+    static native boolean URFrameStream_dispose(NativeWrapper.JniObject stream);
+
     // URDecoder
-    static native UR URDecoder_decode(String encoded);
+    static native UR URDecoder_decode(String encoded, long maxRetainedBytes);
 
-    static native NativeWrapper.JniObject URDecoder_new();
+    static native NativeWrapper.JniObject URDecoder_new(long maxExpectedParts,
+                                                        long maxPendingMixedParts,
+                                                        long maxRetainedBytes,
+                                                        long maxReductionWork);
 
     static native String URDecoder_expected_type(NativeWrapper.JniObject decoder);
 
@@ -1,4 +1,5 @@
 #include <jni.h>
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <cassert>
@@ -9,6 +10,8 @@
 #include <vector>
 #include <cxxabi.h>
 #include <bc-ur.hpp>
+#include "decoder-limits.hpp"
+#include "frame-stream.hpp"
 
 using namespace ur;
 
@@ -307,6 +310,20 @@ static T call(JNIEnv *env, T errorValReturn, CALLABLE func) {
     }
 }
 
+// FrameStream writing into Java allocated direct buffers, with the global references that keep
+// them alive until the producer thread is joined
+struct FrameStreamHandle {
+    std::unique_ptr<FrameStream> stream;
+    std::vector<jobject> frames;
+};
+
+// Clamps a Java limit to size_t, so large limits stay large on 32-bit ABIs instead of wrapping
+static size_t to_size_limit(jlong limit) {
+    if (limit <= 0)
+        return 0;
+    return (size_t) std::min<unsigned long long>((unsigned long long) limit, SIZE_MAX);
+}
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -355,24 +372,6 @@ Java_com_bc_ur_URJni_UR_1new_1from_1message(JNIEnv *env,
     });
 }
 
-JNIEXPORT jbyteArray JNICALL
-Java_com_bc_ur_URJni_UR_1get_1message(JNIEnv *env, jclass clazz, jobject ur) {
-    if (ur == nullptr) {
-        IllegalArgumentExceptionJni::throw_new(env, "Error: Java UR is null");
-        return nullptr;
-    }
-
-    return call<jbyteArray>(env, nullptr, [&]() {
-        auto c_ur = URJni::to_c_UR(env, ur);
-        auto cbor = c_ur->cbor();
-        auto i = cbor.begin();
-        auto end = cbor.end();
-        ByteVector msg;
-        CborLite::decodeBytes(i, end, msg);
-        return PrimitiveJni::to_jbyteArray(env, msg);
-    });
-}
-
 JNIEXPORT jstring JNICALL
 Java_com_bc_ur_URJni_UREncoder_1encode(JNIEnv *env, jclass clazz, jobject ur) {
     if (ur == nullptr) {
@@ -491,7 +490,150 @@ Java_com_bc_ur_URJni_UREncoder_1next_1part(JNIEnv *env, jclass clazz, jobject en
 }
 
 JNIEXPORT jobject JNICALL
-Java_com_bc_ur_URJni_URDecoder_1decode(JNIEnv *env, jclass clazz, jstring encoded) {
+Java_com_bc_ur_URJni_URFrameStream_1new(JNIEnv *env,
+                                        jclass clazz,
+                                        jobject ur,
+                                        jint max_fragment_len,
+                                        jint first_seq_num,
+                                        jint min_fragment_len,
+                                        jint frames_ahead) {
+    if (ur == nullptr) {
+        IllegalArgumentExceptionJni::throw_new(env, "Error: Java UR is null");
+        return nullptr;
+    }
+
+    return call<jobject>(env, nullptr, [&]() {
+        auto c_ur = URJni::to_c_UR(env, ur);
+        auto c_handle = new FrameStreamHandle();
+        try {
+            c_handle->stream = std::make_unique<FrameStream>(*c_ur,
+                                                             max_fragment_len,
+                                                             first_seq_num,
+                                                             min_fragment_len,
+                                                             frames_ahead < 0 ? 0 : frames_ahead);
+        } catch (...) {
+            delete c_handle;
+            throw;
+        }
+        return ObjectJni::new_object(env, c_handle);
+    });
+}
+
+JNIEXPORT jint JNICALL
+Java_com_bc_ur_URJni_URFrameStream_1frame_1count(JNIEnv *env, jclass clazz, jobject stream) {
+    if (stream == nullptr) {
+        IllegalArgumentExceptionJni::throw_new(env, "Error: Java FrameStream is null");
+        return JNI_ERR;
+    }
+
+    return call<jint>(env, JNI_ERR, [&]() {
+        auto c_handle = static_cast<FrameStreamHandle *>(ObjectJni::get_object(env, stream));
+        return (jint) c_handle->stream->frame_count();
+    });
+}
+
+JNIEXPORT jint JNICALL
+Java_com_bc_ur_URJni_URFrameStream_1frame_1capacity(JNIEnv *env, jclass clazz, jobject stream) {
+    if (stream == nullptr) {
+        IllegalArgumentExceptionJni::throw_new(env, "Error: Java FrameStream is null");
+        return JNI_ERR;
+    }
+
+    return call<jint>(env, JNI_ERR, [&]() {
+        auto c_handle = static_cast<FrameStreamHandle *>(ObjectJni::get_object(env, stream));
+        return (jint) c_handle->stream->frame_capacity();
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_bc_ur_URJni_URFrameStream_1start(JNIEnv *env,
+                                          jclass clazz,
+                                          jobject stream,
+                                          jobjectArray frames) {
+    if (stream == nullptr) {
+        IllegalArgumentExceptionJni::throw_new(env, "Error: Java FrameStream is null");
+        return JNI_FALSE;
+    }
+    if (frames == nullptr) {
+        IllegalArgumentExceptionJni::throw_new(env, "Error: Java frames is null");
+        return JNI_FALSE;
+    }
+
+    return call<jboolean>(env, JNI_FALSE, [&]() {
+        auto c_handle = static_cast<FrameStreamHandle *>(ObjectJni::get_object(env, stream));
+        if (!c_handle->frames.empty())
+            throw std::logic_error("frame stream is already started");
+
+        std::vector<uint8_t *> c_frames;
+        jsize len = env->GetArrayLength(frames);
+        for (jsize i = 0; i < len; i++) {
+            jobject frame = env->GetObjectArrayElement(frames, i);
+            auto data = frame == nullptr ? nullptr : env->GetDirectBufferAddress(frame);
+            auto capacity = frame == nullptr ? -1 : env->GetDirectBufferCapacity(frame);
+            if (data == nullptr ||
+                capacity < (jlong) c_handle->stream->frame_capacity()) {
+                env->DeleteLocalRef(frame);
+                throw std::invalid_argument("frame is not a direct buffer of frame capacity");
+            }
+            c_handle->frames.push_back(env->NewGlobalRef(frame));
+            c_frames.push_back(static_cast<uint8_t *>(data));
+            env->DeleteLocalRef(frame);
+        }
+
+        c_handle->stream->start(c_frames);
+        return (jboolean) true;
+    });
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_bc_ur_URJni_URFrameStream_1seq_1len(JNIEnv *env, jclass clazz, jobject stream) {
+    if (stream == nullptr) {
+        IllegalArgumentExceptionJni::throw_new(env, "Error: Java FrameStream is null");
+        return JNI_ERR;
+    }
+
+    return call<jlong>(env, JNI_ERR, [&]() {
+        auto c_handle = static_cast<FrameStreamHandle *>(ObjectJni::get_object(env, stream));
+        return (jlong) c_handle->stream->seq_len();
+    });
+}
+
+JNIEXPORT jint JNICALL
+Java_com_bc_ur_URJni_URFrameStream_1next_1frame(JNIEnv *env, jclass clazz, jobject stream) {
+    if (stream == nullptr) {
+        IllegalArgumentExceptionJni::throw_new(env, "Error: Java FrameStream is null");
+        return JNI_ERR;
+    }
+
+    return call<jint>(env, JNI_ERR, [&]() {
+        auto c_handle = static_cast<FrameStreamHandle *>(ObjectJni::get_object(env, stream));
+        return (jint) c_handle->stream->next_frame();
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_bc_ur_URJni_URFrameStream_1dispose(JNIEnv *env, jclass clazz, jobject stream) {
+    if (stream == nullptr) {
+        IllegalArgumentExceptionJni::throw_new(env, "Error: Java FrameStream is null");
+        return JNI_FALSE;
+    }
+
+    return call(env, JNI_FALSE, [&]() {
+        auto c_handle = static_cast<FrameStreamHandle *>(ObjectJni::get_object(env, stream));
+        // join the producer before the frames it writes to may be collected
+        c_handle->stream.reset();
+        for (auto frame: c_handle->frames)
+            env->DeleteGlobalRef(frame);
+        delete c_handle;
+        return true;
+    });
+}
+
+JNIEXPORT jobject JNICALL
+Java_com_bc_ur_URJni_URDecoder_1decode(JNIEnv *env,
+                                        jclass clazz,
+                                        jstring encoded,
+                                        jlong max_retained_bytes) {
     if (encoded == nullptr) {
         IllegalArgumentExceptionJni::throw_new(env, "Error: Java Decoder is null");
         return nullptr;
@@ -499,15 +641,25 @@ Java_com_bc_ur_URJni_URDecoder_1decode(JNIEnv *env, jclass clazz, jstring encode
 
     return call<jobject>(env, nullptr, [&]() {
         auto c_encoded = PrimitiveJni::copy_std_string(env, encoded);
-        auto c_ur = URDecoder::decode(c_encoded);
+        auto c_ur = LimitedURDecoder::decode(c_encoded, to_size_limit(max_retained_bytes));
         return URJni::to_j_UR(env, c_ur.type(), c_ur.cbor());
     });
 }
 
 JNIEXPORT jobject JNICALL
-Java_com_bc_ur_URJni_URDecoder_1new(JNIEnv *env, jclass clazz) {
+Java_com_bc_ur_URJni_URDecoder_1new(JNIEnv *env,
+                                    jclass clazz,
+                                    jlong max_expected_parts,
+                                    jlong max_pending_mixed_parts,
+                                    jlong max_retained_bytes,
+                                    jlong max_reduction_work) {
     return call<jobject>(env, nullptr, [&]() {
-        auto c_decoder = new URDecoder();
+        DecoderLimits limits;
+        limits.max_expected_parts = to_size_limit(max_expected_parts);
+        limits.max_pending_mixed_parts = to_size_limit(max_pending_mixed_parts);
+        limits.max_retained_bytes = to_size_limit(max_retained_bytes);
+        limits.max_reduction_work = to_size_limit(max_reduction_work);
+        auto c_decoder = new LimitedURDecoder(limits);
         return ObjectJni::new_object(env, c_decoder);
     });
 }
@@ -520,7 +672,7 @@ Java_com_bc_ur_URJni_URDecoder_1expected_1type(JNIEnv *env, jclass clazz, jobjec
     }
 
     return call<jstring>(env, nullptr, [&]() {
-        auto c_decoder = static_cast<URDecoder *>(ObjectJni::get_object(env, decoder));
+        auto c_decoder = static_cast<LimitedURDecoder *>(ObjectJni::get_object(env, decoder));
         auto result = (c_decoder->expected_type()).value();
         return PrimitiveJni::to_jstring(env, &result);
     });
@@ -534,7 +686,7 @@ Java_com_bc_ur_URJni_URDecoder_1expected_1part_1count(JNIEnv *env, jclass clazz,
     }
 
     return call<jlong>(env, JNI_ERR, [&]() {
-        auto c_decoder = static_cast<URDecoder *>(ObjectJni::get_object(env, decoder));
+        auto c_decoder = static_cast<LimitedURDecoder *>(ObjectJni::get_object(env, decoder));
         try {
             return (jlong) c_decoder->expected_part_count();
         } catch (const std::bad_optional_access &e) {
@@ -553,7 +705,7 @@ Java_com_bc_ur_URJni_URDecoder_1received_1part_1indexes(JNIEnv *env,
     }
 
     return call<jintArray>(env, nullptr, [&]() {
-        auto c_decoder = static_cast<URDecoder *>(ObjectJni::get_object(env, decoder));
+        auto c_decoder = static_cast<LimitedURDecoder *>(ObjectJni::get_object(env, decoder));
         const auto &result = c_decoder->received_part_indexes();
         return PrimitiveJni::to_jintArray(env, result);
     });
@@ -568,7 +720,7 @@ Java_com_bc_ur_URJni_URDecoder_1last_1part_1indexes(JNIEnv *env, jclass clazz, j
     }
 
     return call<jintArray>(env, nullptr, [&]() {
-        auto c_decoder = static_cast<URDecoder *>(ObjectJni::get_object(env, decoder));
+        auto c_decoder = static_cast<LimitedURDecoder *>(ObjectJni::get_object(env, decoder));
         const auto &result = c_decoder->last_part_indexes();
         return PrimitiveJni::to_jintArray(env, result);
     });
@@ -584,7 +736,7 @@ Java_com_bc_ur_URJni_URDecoder_1processed_1parts_1count(JNIEnv *env,
     }
 
     return call<jlong>(env, JNI_ERR, [&]() {
-        auto c_decoder = static_cast<URDecoder *>(ObjectJni::get_object(env, decoder));
+        auto c_decoder = static_cast<LimitedURDecoder *>(ObjectJni::get_object(env, decoder));
         return (jlong) c_decoder->processed_parts_count();
     });
 }
@@ -599,7 +751,7 @@ Java_com_bc_ur_URJni_URDecoder_1estimated_1percent_1complete(JNIEnv *env,
     }
 
     return call<jdouble>(env, JNI_ERR, [&]() {
-        auto c_decoder = static_cast<URDecoder *>(ObjectJni::get_object(env, decoder));
+        auto c_decoder = static_cast<LimitedURDecoder *>(ObjectJni::get_object(env, decoder));
         return (jdouble) c_decoder->estimated_percent_complete();;
     });
 }
@@ -612,7 +764,7 @@ Java_com_bc_ur_URJni_URDecoder_1is_1success(JNIEnv *env, jclass clazz, jobject d
     }
 
     return call<jboolean>(env, JNI_FALSE, [&]() {
-        auto c_decoder = static_cast<URDecoder *>(ObjectJni::get_object(env, decoder));
+        auto c_decoder = static_cast<LimitedURDecoder *>(ObjectJni::get_object(env, decoder));
         return (jboolean) c_decoder->is_success();
     });
 }
@@ -625,7 +777,7 @@ Java_com_bc_ur_URJni_URDecoder_1is_1failed(JNIEnv *env, jclass clazz, jobject de
     }
 
     return call<jboolean>(env, JNI_FALSE, [&]() {
-        auto c_decoder = static_cast<URDecoder *>(ObjectJni::get_object(env, decoder));
+        auto c_decoder = static_cast<LimitedURDecoder *>(ObjectJni::get_object(env, decoder));
         return (jboolean) c_decoder->is_failure();
     });
 }
@@ -638,7 +790,7 @@ Java_com_bc_ur_URJni_URDecoder_1is_1complete(JNIEnv *env, jclass clazz, jobject
     }
 
     return call<jboolean>(env, JNI_FALSE, [&]() {
-        auto c_decoder = static_cast<URDecoder *>(ObjectJni::get_object(env, decoder));
+        auto c_decoder = static_cast<LimitedURDecoder *>(ObjectJni::get_object(env, decoder));
         return (jboolean) c_decoder->is_complete();
     });
 }
@@ -651,7 +803,7 @@ Java_com_bc_ur_URJni_URDecoder_1result_1ur(JNIEnv *env, jclass clazz, jobject de
     }
 
     return call<jobject>(env, nullptr, [&]() {
-        auto c_decoder = static_cast<URDecoder *>(ObjectJni::get_object(env, decoder));
+        auto c_decoder = static_cast<LimitedURDecoder *>(ObjectJni::get_object(env, decoder));
         const auto &c_ur = c_decoder->result_ur();
         return URJni::to_j_UR(env, c_ur.type(), c_ur.cbor());
     });
@@ -665,7 +817,7 @@ Java_com_bc_ur_URJni_URDecoder_1result_1error(JNIEnv *env, jclass clazz, jobject
     }
 
     return call<jthrowable>(env, nullptr, [&]() {
-        auto c_decoder = static_cast<URDecoder *>(ObjectJni::get_object(env, decoder));
+        auto c_decoder = static_cast<LimitedURDecoder *>(ObjectJni::get_object(env, decoder));
         const auto &ex = c_decoder->result_error();
         auto name = std::string(typeid(ex).name()) + ":" + ex.what();
         return (jthrowable) URExceptionJni::new_object(env, name);
@@ -683,7 +835,7 @@ Java_com_bc_ur_URJni_URDecoder_1receive_1part(JNIEnv *env,
     }
 
     return call<jboolean>(env, JNI_FALSE, [&]() {
-        auto c_decoder = static_cast<URDecoder *>(ObjectJni::get_object(env, decoder));
+        auto c_decoder = static_cast<LimitedURDecoder *>(ObjectJni::get_object(env, decoder));
         auto cs = PrimitiveJni::copy_std_string(env, s);
         return (jboolean) c_decoder->receive_part(cs);
     });
@@ -697,7 +849,7 @@ Java_com_bc_ur_URJni_URDecoder_1dispose(JNIEnv *env, jclass clazz, jobject decod
     }
 
     return call(env, JNI_FALSE, [&]() {
-        auto c_decoder = static_cast<URDecoder *>(ObjectJni::get_object(env, decoder));
+        auto c_decoder = static_cast<LimitedURDecoder *>(ObjectJni::get_object(env, decoder));
         delete c_decoder;
         return true;
     });
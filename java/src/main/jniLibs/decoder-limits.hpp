@@ -0,0 +1,319 @@
+#ifndef BC_UR_JAVA_DECODER_LIMITS_HPP
+#define BC_UR_JAVA_DECODER_LIMITS_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include <bc-ur.hpp>
+
+// Resource limits applied to untrusted parts before they reach ur::FountainDecoder.
+// A value of 0 means the limit is disabled.
+struct DecoderLimits {
+    // maximum `seq-len` a multi-part UR may announce
+    size_t max_expected_parts = 0;
+
+    // maximum number of mixed (degree > 1) parts waiting to be reduced
+    size_t max_pending_mixed_parts = 0;
+
+    // maximum number of bytes the decoder may hold for one message, estimated as
+    // fragment length times the number of simple and pending mixed parts
+    size_t max_retained_bytes = 0;
+
+    // maximum number of bytes XOR-ed while reducing a single incoming part, estimated as
+    // fragment length times the number of pending mixed parts and fragments it touches
+    size_t max_reduction_work = 0;
+
+    bool is_unlimited() const {
+        return max_expected_parts == 0 && max_pending_mixed_parts == 0 &&
+               max_retained_bytes == 0 && max_reduction_work == 0;
+    }
+};
+
+class DecoderLimitExceeded : public std::runtime_error {
+public:
+    explicit DecoderLimitExceeded(const std::string &msg) : std::runtime_error(msg) {}
+};
+
+// Multi-part UR decoder guarded by DecoderLimits.
+//
+// Without limits every call is forwarded to ur::URDecoder. With limits this follows
+// ur::URDecoder, but drives ur::FountainDecoder directly so that every part is bytewords and
+// CBOR decoded once and the parsed part is shared by the limit checks and the decoder. Limits on costs that grow with the pending mixed parts are only charged to parts
+// that would be added to them; simple parts, and mixed parts with at most one unknown
+// fragment, always reduce the queue and are never rejected for it.
+//
+// The fountain decoder does not expose its mixed part queue, so a shadow copy of the pending
+// mixed part indexes is kept here. A mixed part is dropped from the shadow once at most one of
+// its fragments is still unknown, which is when the decoder reduces it to a simple part.
+class LimitedURDecoder {
+public:
+    typedef std::variant<ur::UR, std::exception> Result;
+
+    explicit LimitedURDecoder(const DecoderLimits &limits) : limits_(limits) {}
+
+    const DecoderLimits &limits() const { return limits_; }
+
+    size_t pending_mixed_parts() const { return pending_mixed_.size(); }
+
+    const std::optional<std::string> &expected_type() const {
+        return unlimited() ? decoder_.expected_type() : expected_type_;
+    }
+
+    size_t expected_part_count() const {
+        return unlimited() ? decoder_.expected_part_count()
+                           : fountain_decoder_.expected_part_count();
+    }
+
+    const ur::PartIndexes &received_part_indexes() const {
+        return unlimited() ? decoder_.received_part_indexes()
+                           : fountain_decoder_.received_part_indexes();
+    }
+
+    const ur::PartIndexes &last_part_indexes() const {
+        return unlimited() ? decoder_.last_part_indexes()
+                           : fountain_decoder_.last_part_indexes();
+    }
+
+    size_t processed_parts_count() const {
+        return unlimited() ? decoder_.processed_parts_count()
+                           : fountain_decoder_.processed_parts_count();
+    }
+
+    double estimated_percent_complete() const {
+        if (unlimited())
+            return decoder_.estimated_percent_complete();
+        return is_complete() ? 1 : fountain_decoder_.estimated_percent_complete();
+    }
+
+    bool is_success() const {
+        if (unlimited())
+            return decoder_.is_success();
+        return result_ && std::holds_alternative<ur::UR>(*result_);
+    }
+
+    bool is_failure() const {
+        if (unlimited())
+            return decoder_.is_failure();
+        return result_ && std::holds_alternative<std::exception>(*result_);
+    }
+
+    bool is_complete() const {
+        return unlimited() ? decoder_.is_complete() : result_.has_value();
+    }
+
+    const ur::UR &result_ur() const {
+        return unlimited() ? decoder_.result_ur() : std::get<ur::UR>(result_.value());
+    }
+
+    const std::exception &result_error() const {
+        return unlimited() ? decoder_.result_error() : std::get<std::exception>(result_.value());
+    }
+
+    // Returns false if `s` is malformed or does not belong to the UR being decoded, and throws
+    // DecoderLimitExceeded if accepting it would exceed a limit.
+    bool receive_part(const std::string &s) {
+        if (unlimited())
+            return decoder_.receive_part(s);
+        if (is_complete())
+            return false;
+
+        auto lowered = to_lower(s);
+        if (lowered.rfind("ur:", 0) != 0)
+            return false;
+        auto type_end = lowered.find('/');
+        if (type_end == std::string::npos)
+            return false;
+        auto seq_end = lowered.find('/', type_end + 1);
+        auto type = lowered.substr(3, type_end - 3);
+
+        // like ur::URDecoder, a part of another type is rejected before any other check
+        if (!validate_type(type))
+            return false;
+
+        if (seq_end == std::string::npos) {
+            check_single_part(lowered, limits_);
+            try {
+                result_ = ur::URDecoder::decode(lowered);
+            } catch (const std::exception &) {
+                return false;
+            }
+            return true;
+        }
+
+        // reject an oversized `seq-len` before anything allocates in proportion to it
+        uint32_t seq_num;
+        size_t seq_len;
+        if (!parse_sequence(lowered.substr(type_end + 1, seq_end - type_end - 1),
+                            seq_num,
+                            seq_len))
+            return false;
+        if (limits_.max_expected_parts != 0 && seq_len > limits_.max_expected_parts)
+            throw DecoderLimitExceeded("UR part exceeds max expected parts");
+
+        std::optional<ur::FountainEncoder::Part> part;
+        try {
+            auto cbor = ur::Bytewords::decode(ur::Bytewords::style::minimal,
+                                              lowered.substr(seq_end + 1));
+            part.emplace(cbor);
+        } catch (const std::exception &) {
+            return false;
+        }
+        if (part->seq_num() != seq_num || part->seq_len() != seq_len)
+            return false;
+        auto indexes = check_part(*part);
+
+        try {
+            if (!fountain_decoder_.receive_part(*part))
+                return false;
+        } catch (const std::exception &) {
+            return false;
+        }
+
+        if (fountain_decoder_.is_success())
+            result_ = ur::UR(type, fountain_decoder_.result_message());
+        else if (fountain_decoder_.is_failure())
+            result_ = fountain_decoder_.result_error();
+
+        if (indexes.size() > 1)
+            pending_mixed_.insert(indexes);
+        prune_pending_mixed();
+        return true;
+    }
+
+    // Fails fast on a single-part UR whose body would decode to more than max_retained_bytes.
+    static ur::UR decode(const std::string &s, size_t max_retained_bytes) {
+        DecoderLimits limits;
+        limits.max_retained_bytes = max_retained_bytes;
+        check_single_part(s, limits);
+        return ur::URDecoder::decode(s);
+    }
+
+private:
+    DecoderLimits limits_;
+    ur::URDecoder decoder_;
+    ur::FountainDecoder fountain_decoder_;
+    std::optional<std::string> expected_type_;
+    std::optional<Result> result_;
+    std::set<ur::PartIndexes> pending_mixed_;
+
+    bool unlimited() const { return limits_.is_unlimited(); }
+
+    static void check_single_part(const std::string &s, const DecoderLimits &limits) {
+        // minimal bytewords encode every byte as two letters
+        auto body_len = s.size() - (s.rfind('/') + 1);
+        if (limits.max_retained_bytes != 0 && body_len / 2 > limits.max_retained_bytes)
+            throw DecoderLimitExceeded("UR exceeds max retained bytes");
+    }
+
+    static std::string to_lower(const std::string &s) {
+        std::string result(s);
+        for (auto &c: result)
+            c = (char) std::tolower((unsigned char) c);
+        return result;
+    }
+
+    static bool parse_sequence(const std::string &seq, uint32_t &seq_num, size_t &seq_len) {
+        auto dash = seq.find('-');
+        if (dash == 0 || dash == std::string::npos || dash + 1 >= seq.size() ||
+            seq.find_first_not_of("0123456789-") != std::string::npos ||
+            seq.find('-', dash + 1) != std::string::npos)
+            return false;
+
+        unsigned long long num, len;
+        try {
+            num = std::stoull(seq.substr(0, dash));
+            len = std::stoull(seq.substr(dash + 1));
+        } catch (const std::exception &) {
+            return false;
+        }
+        if (num < 1 || num > UINT32_MAX || len < 1 || len > SIZE_MAX)
+            return false;
+
+        seq_num = (uint32_t) num;
+        seq_len = (size_t) len;
+        return true;
+    }
+
+    bool validate_type(const std::string &type) {
+        if (type.empty() || type.find_first_not_of("abcdefghijklmnopqrstuvwxyz0123456789-") !=
+                            std::string::npos)
+            return false;
+        if (!expected_type_) {
+            expected_type_ = type;
+            return true;
+        }
+        return *expected_type_ == type;
+    }
+
+    // Throws DecoderLimitExceeded if accepting `part` would exceed a limit. Returns the
+    // fragment indexes of the part if it would be added to the pending mixed parts, or an
+    // empty set if it reduces them.
+    ur::PartIndexes check_part(const ur::FountainEncoder::Part &part) {
+        // compare part counts rather than byte counts so a huge `seq-len` cannot overflow
+        auto fragment_len = std::max<size_t>(part.data().size(), 1);
+        if (limits_.max_retained_bytes != 0 &&
+            (part.message_len() > limits_.max_retained_bytes ||
+             part.seq_len() > limits_.max_retained_bytes / fragment_len))
+            throw DecoderLimitExceeded("UR part exceeds max retained bytes");
+
+        // simple parts never need fragment selection
+        if (part.seq_num() <= part.seq_len())
+            return {};
+
+        auto indexes = ur::choose_fragments(part.seq_num(), part.seq_len(), part.checksum());
+        if (limits_.max_reduction_work != 0 &&
+            indexes.size() > limits_.max_reduction_work / fragment_len)
+            throw DecoderLimitExceeded("UR part exceeds max reduction work");
+
+        if (!is_pending(indexes) || pending_mixed_.find(indexes) != pending_mixed_.end())
+            return {};
+
+        // only parts that grow the pending mixed parts are charged for them
+        if (limits_.max_pending_mixed_parts != 0 &&
+            pending_mixed_.size() >= limits_.max_pending_mixed_parts)
+            throw DecoderLimitExceeded("UR part exceeds max pending mixed parts");
+
+        if (limits_.max_retained_bytes != 0 &&
+            part.seq_len() + pending_mixed_.size() + 1 >
+            limits_.max_retained_bytes / fragment_len)
+            throw DecoderLimitExceeded("UR part exceeds max retained bytes");
+
+        if (limits_.max_reduction_work != 0 &&
+            pending_mixed_.size() + indexes.size() > limits_.max_reduction_work / fragment_len)
+            throw DecoderLimitExceeded("UR part exceeds max reduction work");
+
+        return indexes;
+    }
+
+    // A mixed part stays pending while more than one of its fragments is unknown.
+    bool is_pending(const ur::PartIndexes &indexes) const {
+        const auto &received = fountain_decoder_.received_part_indexes();
+        size_t unknown = 0;
+        for (auto index: indexes) {
+            if (received.find(index) == received.end() && ++unknown > 1)
+                return true;
+        }
+        return false;
+    }
+
+    void prune_pending_mixed() {
+        if (pending_mixed_.empty())
+            return;
+        if (is_complete()) {
+            pending_mixed_.clear();
+            return;
+        }
+
+        for (auto it = pending_mixed_.begin(); it != pending_mixed_.end();) {
+            it = is_pending(*it) ? std::next(it) : pending_mixed_.erase(it);
+        }
+    }
+};
+
+#endif //BC_UR_JAVA_DECODER_LIMITS_HPP
@@ -0,0 +1,155 @@
+#ifndef BC_UR_JAVA_FRAME_STREAM_HPP
+#define BC_UR_JAVA_FRAME_STREAM_HPP
+
+#include <cctype>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <bc-ur.hpp>
+
+// Streams the parts of a ur::UREncoder as uppercase, QR alphanumeric mode ready bytes.
+//
+// A producer thread runs up to `frames_ahead` parts ahead of the consumer and writes them
+// into a fixed ring of `frames_ahead + 1` slots. Slot memory is owned by the caller and handed
+// over in start(); it must stay valid until the stream is destroyed, which joins the producer.
+// Slots are handed out in ring order, and the slot returned by next_frame() stays owned by the
+// consumer until the following call.
+class FrameStream {
+public:
+    FrameStream(const ur::UR &ur,
+                size_t max_fragment_len,
+                uint32_t first_seq_num,
+                size_t min_fragment_len,
+                size_t frames_ahead)
+            : encoder_(ur, max_fragment_len, first_seq_num, min_fragment_len) {
+        if (frames_ahead == 0)
+            throw std::invalid_argument("frames ahead must be positive");
+
+        // fragments are padded to the same length, so parts only differ in `seq-num`: at most
+        // 10 digits in the header, and at most 5 CBOR bytes in the body, which minimal bytewords
+        // encode as 2 characters each, so at most 10 characters
+        first_part_ = encoder_.next_part();
+        seq_len_ = encoder_.seq_len();
+        frame_capacity_ = first_part_.size() + 20;
+        slots_.resize(frames_ahead + 1);
+    }
+
+    ~FrameStream() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopped_ = true;
+        }
+        not_full_.notify_all();
+        not_empty_.notify_all();
+        if (producer_.joinable())
+            producer_.join();
+    }
+
+    FrameStream(const FrameStream &) = delete;
+
+    FrameStream &operator=(const FrameStream &) = delete;
+
+    size_t seq_len() const { return seq_len_; }
+
+    size_t frame_count() const { return slots_.size(); }
+
+    size_t frame_capacity() const { return frame_capacity_; }
+
+    // Starts producing into `frames`, one buffer of at least frame_capacity() bytes per slot.
+    void start(const std::vector<uint8_t *> &frames) {
+        if (producer_.joinable())
+            throw std::logic_error("frame stream is already started");
+        if (frames.size() != slots_.size())
+            throw std::invalid_argument("frame count does not match");
+
+        for (size_t i = 0; i < slots_.size(); i++)
+            slots_[i].data = frames[i];
+        write_slot(slots_[0], first_part_);
+        first_part_.clear();
+        produced_ = 1;
+
+        producer_ = std::thread(&FrameStream::produce, this);
+    }
+
+    // Releases the previously returned slot and blocks until the next one is ready.
+    // Returns the length of the part written to slot `consumed % frame_count()`.
+    size_t next_frame() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        released_ = consumed_;
+        not_full_.notify_one();
+        not_empty_.wait(lock, [&]() {
+            return stopped_ || !error_.empty() || produced_ > consumed_;
+        });
+
+        if (produced_ <= consumed_) {
+            if (!error_.empty())
+                throw std::runtime_error(error_);
+            throw std::runtime_error("frame stream is stopped");
+        }
+        return slots_[consumed_++ % slots_.size()].len;
+    }
+
+private:
+    struct Slot {
+        uint8_t *data = nullptr;
+        size_t len = 0;
+    };
+
+    ur::UREncoder encoder_;
+    std::string first_part_;
+    size_t seq_len_ = 0;
+    size_t frame_capacity_ = 0;
+    std::vector<Slot> slots_;
+
+    std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+    uint64_t produced_ = 0;
+    uint64_t consumed_ = 0;
+    uint64_t released_ = 0;
+    bool stopped_ = false;
+    std::string error_;
+
+    std::thread producer_;
+
+    void write_slot(Slot &slot, const std::string &part) {
+        if (part.size() > frame_capacity_)
+            throw std::length_error("part exceeds frame capacity");
+        for (size_t i = 0; i < part.size(); i++)
+            slot.data[i] = (uint8_t) std::toupper((unsigned char) part[i]);
+        slot.len = part.size();
+    }
+
+    void produce() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            not_full_.wait(lock, [&]() {
+                return stopped_ || produced_ - released_ < slots_.size();
+            });
+            if (stopped_)
+                return;
+
+            // the slot is not visible to the consumer until produced_ is bumped
+            auto &slot = slots_[produced_ % slots_.size()];
+            lock.unlock();
+            try {
+                write_slot(slot, encoder_.next_part());
+            } catch (const std::exception &e) {
+                lock.lock();
+                error_ = e.what();
+                not_empty_.notify_one();
+                return;
+            }
+            lock.lock();
+
+            produced_++;
+            not_empty_.notify_one();
+        }
+    }
+};
+
+#endif //BC_UR_JAVA_FRAME_STREAM_HPP
@@ -90,4 +90,131 @@ public class URDecoderTest {
             assertThrows("test failed due to " + it, URException.class, () -> URDecoder.decode(it));
         }
     }
-}
\ No newline at end of file
+
+    @Test
+    public void testDecodeMaxRetainedBytes() {
+        String encoded = "ur:bytes/hdeymejtswhhylkepmykhhtsytsnoyoyaxaedsuttydmmhhpktpmsrjtgwdpfnsboxgwlbaawzuefywkdplrsrjynbvygabwjldapfcsdwkbrkch";
+        assertThrows("test failed due to max retained bytes",
+                     URException.class,
+                     () -> URDecoder.decode(encoded, 10));
+        assertEquals("bytes", URDecoder.decode(encoded, 1000).getType());
+    }
+
+    @Test
+    public void testReceivePartMaxExpectedParts() throws Exception {
+        UR ur = UR_new_from_len_seed_string(32767, "Wolf");
+
+        // 33 parts are announced but only 10 are allowed
+        try (UREncoder encoder = new UREncoder(ur, 1000, 100, 10);
+             URDecoder decoder = new URDecoder(URDecoder.Limits.UNLIMITED.withMaxExpectedParts(10))) {
+            assertThrows("test failed due to max expected parts",
+                         URException.class,
+                         () -> decoder.receivePart(encoder.nextPart()));
+        }
+    }
+
+    @Test
+    public void testReceivePartMaxRetainedBytes() throws Exception {
+        UR ur = UR_new_from_len_seed_string(32767, "Wolf");
+
+        try (UREncoder encoder = new UREncoder(ur, 1000, 100, 10);
+             URDecoder decoder = new URDecoder(URDecoder.Limits.UNLIMITED.withMaxRetainedBytes(10000))) {
+            assertThrows("test failed due to max retained bytes",
+                         URException.class,
+                         () -> decoder.receivePart(encoder.nextPart()));
+            assertEquals(0L, decoder.processedPartsCount());
+        }
+    }
+
+    @Test
+    public void testReceivePartMaxPendingMixedParts() throws Exception {
+        UR ur = UR_new_from_len_seed_string(32767, "Wolf");
+
+        // skip every simple part so that mixed parts can never be reduced
+        try (UREncoder encoder = new UREncoder(ur, 1000, 0, 10);
+             URDecoder decoder = new URDecoder(URDecoder.Limits.UNLIMITED.withMaxPendingMixedParts(5))) {
+            assertThrows("test failed due to max pending mixed parts",
+                         URException.class,
+                         () -> receiveMixedParts(encoder, decoder, 1000));
+            assertFalse(decoder.isComplete());
+        }
+    }
+
+    @Test
+    public void testReceivePartMaxReductionWork() throws Exception {
+        UR ur = UR_new_from_len_seed_string(32767, "Wolf");
+
+        // about 10 fragments of 1000 bytes may be combined for one part
+        try (UREncoder mixedEncoder = new UREncoder(ur, 1000, 0, 10);
+             UREncoder simpleEncoder = new UREncoder(ur, 1000, 0, 10);
+             URDecoder decoder = new URDecoder(URDecoder.Limits.UNLIMITED.withMaxReductionWork(10000))) {
+            assertThrows("test failed due to max reduction work",
+                         URException.class,
+                         () -> receiveMixedParts(mixedEncoder, decoder, 1000));
+            assertFalse(decoder.isComplete());
+
+            // simple parts reduce the pending mixed parts, so they are still accepted
+            do {
+                assertTrue(decoder.receivePart(simpleEncoder.nextPart()));
+            } while (!decoder.isComplete());
+            assertTrue(decoder.isSuccess());
+        }
+    }
+
+    @Test
+    public void testReceivePartWithinLimits() throws Exception {
+        UR ur = UR_new_from_len_seed_string(32767, "Wolf");
+
+        // limits which are never reached do not affect decoding
+        try (UREncoder encoder = new UREncoder(ur, 1000, 100, 10);
+             URDecoder decoder = new URDecoder(URDecoder.Limits.UNLIMITED
+                                                       .withMaxExpectedParts(33)
+                                                       .withMaxPendingMixedParts(100)
+                                                       .withMaxRetainedBytes(1 << 20)
+                                                       .withMaxReductionWork(1 << 20))) {
+            do {
+                decoder.receivePart(encoder.nextPart());
+            } while (!decoder.isComplete());
+            assertTrue(decoder.isSuccess());
+        }
+    }
+
+    @Test
+    public void testReceiveSinglePartExpectedType() throws Exception {
+        String encoded = "ur:bytes/hdeymejtswhhylkepmykhhtsytsnoyoyaxaedsuttydmmhhpktpmsrjtgwdpfnsboxgwlbaawzuefywkdplrsrjynbvygabwjldapfcsdwkbrkch";
+        URDecoder.Limits[] limits = new URDecoder.Limits[]{URDecoder.Limits.UNLIMITED,
+                                                           URDecoder.Limits.UNLIMITED.withMaxExpectedParts(33)};
+        for (URDecoder.Limits it : limits) {
+            try (URDecoder decoder = new URDecoder(it)) {
+                assertTrue(decoder.receivePart(encoded));
+                assertTrue(decoder.isSuccess());
+                assertEquals("bytes", decoder.expectedType());
+            }
+        }
+    }
+
+    @Test
+    public void testReceiveForeignSinglePartDuringMultiParts() throws Exception {
+        UR ur = UR_new_from_len_seed_string(32767, "Wolf");
+        UR foreignUR = UR.create("psbt", new byte[]{0x01, 0x03, 0x7F});
+        URDecoder.Limits[] limits = new URDecoder.Limits[]{URDecoder.Limits.UNLIMITED,
+                                                           URDecoder.Limits.UNLIMITED.withMaxExpectedParts(33)};
+        for (URDecoder.Limits it : limits) {
+            try (UREncoder encoder = new UREncoder(ur, 1000);
+                 URDecoder decoder = new URDecoder(it)) {
+                assertTrue(decoder.receivePart(encoder.nextPart()));
+                assertFalse(decoder.receivePart(UREncoder.encode(foreignUR)));
+                assertFalse(decoder.isComplete());
+                assertEquals("bytes", decoder.expectedType());
+            }
+        }
+    }
+
+    private static void receiveMixedParts(UREncoder encoder, URDecoder decoder, int count) {
+        for (int i = 0; i < count; i++) {
+            String part = encoder.nextPart();
+            if (encoder.getLastPartIndexes().length > 1)
+                decoder.receivePart(part);
+        }
+    }
+}
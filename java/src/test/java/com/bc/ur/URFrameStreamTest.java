@@ -0,0 +1,84 @@
+package com.bc.ur;
+
+import org.junit.Test;
+import org.junit.runner.RunWith;
+import org.junit.runners.JUnit4;
+
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+
+import static com.bc.ur.URJni.UR_new_from_len_seed_string;
+import static com.bc.ur.util.TestUtils.assertThrows;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+@RunWith(JUnit4.class)
+public class URFrameStreamTest {
+
+    @Test
+    public void testFramesMatchEncoderParts() throws Exception {
+        UR ur = UR_new_from_len_seed_string(256, "Wolf");
+        URFrameStream refStream;
+
+        try (UREncoder encoder = new UREncoder(ur, 30);
+             URFrameStream stream = new URFrameStream(ur, 30, 3)) {
+            refStream = stream;
+            assertEquals(encoder.getSeqLen(), stream.getSeqLen());
+
+            for (int i = 0; i < 50; i++) {
+                ByteBuffer frame = stream.nextFrame();
+                assertTrue(frame.isDirect());
+                assertTrue(frame.isReadOnly());
+
+                byte[] bytes = new byte[frame.remaining()];
+                frame.get(bytes);
+                assertEquals(encoder.nextPart().toUpperCase(),
+                             new String(bytes, StandardCharsets.US_ASCII));
+            }
+        }
+
+        assertTrue(refStream.isClosed());
+        assertThrows("test failed since stream has not been disposed",
+                     IllegalArgumentException.class,
+                     refStream::nextFrame);
+    }
+
+    @Test
+    public void testSinglePartFrames() throws Exception {
+        UR ur = UR_new_from_len_seed_string(50, "Wolf");
+        String expected = UREncoder.encode(ur).toUpperCase();
+
+        try (URFrameStream stream = new URFrameStream(ur, 1000, 1)) {
+            for (int i = 0; i < 3; i++) {
+                ByteBuffer frame = stream.nextFrame();
+                byte[] bytes = new byte[frame.remaining()];
+                frame.get(bytes);
+                assertEquals(expected, new String(bytes, StandardCharsets.US_ASCII));
+            }
+        }
+    }
+
+    @Test
+    public void testFrameReadableAfterClose() throws Exception {
+        UR ur = UR_new_from_len_seed_string(50, "Wolf");
+        String expected = UREncoder.encode(ur).toUpperCase();
+        ByteBuffer frame;
+
+        try (URFrameStream stream = new URFrameStream(ur, 1000, 2)) {
+            frame = stream.nextFrame();
+        }
+
+        // frames are Java allocated, so they stay readable after the stream is closed
+        byte[] bytes = new byte[frame.remaining()];
+        frame.get(bytes);
+        assertEquals(expected, new String(bytes, StandardCharsets.US_ASCII));
+    }
+
+    @Test
+    public void testInvalidFramesAhead() {
+        UR ur = UR_new_from_len_seed_string(50, "Wolf");
+        assertThrows("test failed due to frames ahead",
+                     URException.class,
+                     () -> new URFrameStream(ur, 1000, 0));
+    }
+}
@@ -4,9 +4,15 @@ import org.junit.Test;
 import org.junit.runner.RunWith;
 import org.junit.runners.JUnit4;
 
+import java.nio.ByteBuffer;
+import java.nio.ReadOnlyBufferException;
+import java.util.Arrays;
+
+import static com.bc.ur.URJni.UR_new_from_len_seed_string;
 import static com.bc.ur.util.TestUtils.assertThrows;
 import static com.bc.ur.util.TestUtils.bytes2Hex;
 import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
 
 @RunWith(JUnit4.class)
 public class URTest {
@@ -28,4 +34,27 @@ public class URTest {
                      URException.class,
                      () -> UR.create("123|@345", bytes));
     }
+
+    @Test
+    public void testGetMessageBuffer() {
+        byte[] bytes = new byte[]{0x01, 0x03, 0x7F, 0x3A, 0x11, 0x54, 0x12};
+        UR ur = UR.create(bytes);
+        ByteBuffer buffer = ur.getMessageBuffer();
+        assertTrue(buffer.isReadOnly());
+        assertEquals(bytes.length, buffer.remaining());
+        assertEquals(0x01, buffer.get());
+
+        // each call returns an independent view
+        assertEquals(bytes.length, ur.getMessageBuffer().remaining());
+        assertThrows("buffer is writable",
+                     ReadOnlyBufferException.class,
+                     () -> ur.getMessageBuffer().put((byte) 0x00));
+
+        // multi-byte CBOR length header
+        UR longUR = UR_new_from_len_seed_string(1000, "Wolf");
+        byte[] message = longUR.getMessage();
+        assertEquals(1000, message.length);
+        assertEquals(1000, longUR.getMessageBuffer().remaining());
+        assertTrue(Arrays.equals(Arrays.copyOfRange(longUR.getCbor(), 3, 1003), message));
+    }
 }